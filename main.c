@@ -2,16 +2,17 @@
 #include <string.h>
 #include <stdlib.h>
 
-#include "./src/risc.h"
+#include "./src/machine.h"
 
-void read_file(CPU *cpu, char *filename) {
+int read_file(MACHINE *machine, char *filename) {
     FILE *file;
     uint8_t *buffer;
     unsigned long file_len;
 
     file = fopen(filename, "rb");
     if (!file) {
-        fprintf(stderr, "Unable to open file %s", filename);
+        fprintf(stderr, "Unable to open file %s\n", filename);
+        return 0;
     }
 
     fseek(file, 0, SEEK_END);
@@ -23,8 +24,13 @@ void read_file(CPU *cpu, char *filename) {
     fread(buffer, file_len, 1, file);
     fclose(file);
 
-    memcpy(cpu->bus->dram->mem, buffer, file_len * sizeof(uint8_t));
+    int loaded = machine_load(machine, buffer, file_len);
     free(buffer);
+
+    if (!loaded)
+        fprintf(stderr, "File %s does not fit in dram\n", filename);
+
+    return loaded;
 }
 
 int main(int argc, char *argv[]) {
@@ -33,23 +39,27 @@ int main(int argc, char *argv[]) {
         exit(1);
     }
 
-    CPU cpu;
-    cpu_initialize(&cpu);
-    read_file(&cpu, argv[1]);
-
-    uint64_t dram_len = sizeof(cpu.bus->dram->mem) / cpu.bus->dram->mem[0];
-    while (1) {
-        uint32_t inst = cpu_fetch(&cpu);
+    MACHINE *machine = machine_create();
+    if (!machine) {
+        fprintf(stderr, "Unable to allocate machine\n");
+        exit(1);
+    }
 
-        cpu.program_counter += 4;
-        if (!cpu_execute(&cpu, inst))
-            break;
+    if (!read_file(machine, argv[1])) {
+        machine_destroy(machine);
+        exit(1);
+    }
 
-        cpu_dump_registers(&cpu);
+    machine_set_trace(machine, 1);
 
-        if (cpu.program_counter == 0)
-            break;
-    }
+    // step one instruction at a time so registers can be dumped after each
+    STOP_REASON reason;
+    do {
+        reason = machine_run(machine, 1, NULL);
+        if (reason == STOP_STEP_LIMIT || reason == STOP_HALT)
+            machine_dump_registers(machine);
+    } while (reason == STOP_STEP_LIMIT);
 
+    machine_destroy(machine);
     return 0;
 }
@@ -3,10 +3,18 @@
 #include "risc.h"
 
 
-uint64_t bus_load(BUS *bus, uint64_t addr, uint64_t size) {
-    return dram_load(bus->dram, addr, size);
+int bus_load(BUS *bus, uint64_t addr, uint64_t size, uint64_t *value) {
+    if (!dram_in_range(addr, size / 8))
+        return 0;
+
+    *value = dram_load(bus->dram, addr, size);
+    return 1;
 }
 
-void bus_store(BUS *bus, uint64_t addr, uint64_t size, uint64_t value) {
+int bus_store(BUS *bus, uint64_t addr, uint64_t size, uint64_t value) {
+    if (!dram_in_range(addr, size / 8))
+        return 0;
+
     dram_store(bus->dram, addr, size, value);
+    return 1;
 }
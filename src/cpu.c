@@ -13,11 +13,16 @@ void cpu_initialize(CPU *cpu) {
 }
 
 uint64_t cpu_load(CPU *cpu, uint64_t addr, uint64_t size) {
-    return bus_load(cpu->bus, addr, size);
+    /* faulting loads read as 0—cpu_execute reports the fault to the caller */
+    uint64_t value = 0;
+    if (!bus_load(cpu->bus, addr, size, &value))
+        cpu->mem_fault = 1;
+    return value;
 }
 
 void cpu_store(CPU *cpu, uint64_t addr, uint64_t size, uint64_t value) {
-    bus_store(cpu->bus, addr, size, value);
+    if (!bus_store(cpu->bus, addr, size, value))
+        cpu->mem_fault = 1;
 }
 
 uint32_t cpu_fetch(CPU *cpu) {
@@ -28,76 +33,82 @@ uint32_t cpu_fetch(CPU *cpu) {
 }
 
 
+static void cpu_trace(CPU *cpu, const char *mnemonic) {
+    if (cpu->trace)
+        printf("%s\n", mnemonic);
+}
+
+
 /* ------ INSTRUCTION EXECUTORS ------- */
 
 void cpu_exec_ADD(CPU *cpu, uint32_t inst) {
     int64_t rs1 = cpu->registers[cpu_decode_rs1(inst)];
     int64_t rs2 = cpu->registers[cpu_decode_rs2(inst)];
     cpu->registers[cpu_decode_rd(inst)] = (uint64_t)(rs1 + rs2);
-    printf("add\n");
+    cpu_trace(cpu, "add");
 }
 
 void cpu_exec_SUB(CPU *cpu, uint32_t inst) {
     int64_t rs1 = cpu->registers[cpu_decode_rs1(inst)];
     int64_t rs2 = cpu->registers[cpu_decode_rs2(inst)];
     cpu->registers[cpu_decode_rd(inst)] = (uint64_t)(rs1 - rs2);
-    printf("sub\n");
+    cpu_trace(cpu, "sub");
 }
 
 void cpu_exec_SLL(CPU *cpu, uint32_t inst) {
     uint64_t rs1 = cpu_decode_rs1(inst);
     uint64_t rs2 = cpu_decode_rs2(inst);
     cpu->registers[cpu_decode_rd(inst)] = cpu->registers[rs1] << (int64_t)cpu->registers[rs2];
-    printf("sll\n");
+    cpu_trace(cpu, "sll");
 }
 
 void cpu_exec_SLT(CPU *cpu, uint32_t inst) {
     uint64_t rs1 = cpu_decode_rs1(inst);
     uint64_t rs2 = cpu_decode_rs2(inst);
     cpu->registers[cpu_decode_rd(inst)] = (cpu->registers[rs1] < (int64_t)cpu->registers[rs2]) ? 1: 0;
-    printf("slt\n");
+    cpu_trace(cpu, "slt");
 }
 
 void cpu_exec_SLTU(CPU *cpu, uint32_t inst) {
     uint64_t rs1 = cpu_decode_rs1(inst);
     uint64_t rs2 = cpu_decode_rs2(inst);
     cpu->registers[cpu_decode_rd(inst)] = (cpu->registers[rs1] < cpu->registers[rs2]) ? 1: 0;
-    printf("sltu\n");
+    cpu_trace(cpu, "sltu");
 }
 
 void cpu_exec_XOR(CPU *cpu, uint32_t inst) {
     uint64_t rs1 = cpu_decode_rs1(inst);
     uint64_t rs2 = cpu_decode_rs2(inst);
     cpu->registers[cpu_decode_rd(inst)] = cpu->registers[rs1] ^ cpu->registers[rs2];
-    printf("xor\n");
+    cpu_trace(cpu, "xor");
 }
 
 void cpu_exec_SRL(CPU *cpu, uint32_t inst) {
     uint64_t rs1 = cpu_decode_rs1(inst);
     uint64_t rs2 = cpu_decode_rs2(inst);
     cpu->registers[cpu_decode_rd(inst)] = cpu->registers[rs1] >> (int64_t)cpu->registers[rs2];
-    printf("srl\n");
+    cpu_trace(cpu, "srl");
 }
 
 void cpu_exec_SRA(CPU *cpu, uint32_t inst) {
     uint64_t rs1 = cpu_decode_rs1(inst);
     uint64_t rs2 = cpu_decode_rs2(inst);
     cpu->registers[cpu_decode_rd(inst)] = (int32_t)cpu->registers[rs1] >> (int64_t)cpu->registers[rs2];
-    printf("sra\n");
+    cpu_trace(cpu, "sra");
 }
 
 void cpu_exec_OR(CPU *cpu, uint32_t inst) {
     uint64_t rs1 = cpu_decode_rs1(inst);
     uint64_t rs2 = cpu_decode_rs2(inst);
     cpu->registers[cpu_decode_rd(inst)] = cpu->registers[rs1] | cpu->registers[rs2];
-    printf("or\n");
+    cpu_trace(cpu, "or");
 }
 
 void cpu_exec_AND(CPU *cpu, uint32_t inst) {
     uint64_t rs1 = cpu_decode_rs1(inst);
     uint64_t rs2 = cpu_decode_rs2(inst);
     cpu->registers[cpu_decode_rd(inst)] = cpu->registers[rs1] & cpu->registers[rs2];
-    printf("and\n");
+    cpu_trace(cpu, "and");
 }
 
 void cpu_exec_ADDI(CPU *cpu, uint32_t inst) {
@@ -105,7 +116,7 @@ void cpu_exec_ADDI(CPU *cpu, uint32_t inst) {
     uint64_t rs1 = cpu_decode_rs1(inst);
     uint64_t rd = cpu_decode_rd(inst);
     cpu->registers[rd] = cpu->registers[rs1] + (int64_t)imm;
-    printf("addi\n");
+    cpu_trace(cpu, "addi");
 }
 
 void cpu_exec_SLLI(CPU* cpu, uint32_t inst) {
@@ -113,7 +124,7 @@ void cpu_exec_SLLI(CPU* cpu, uint32_t inst) {
     uint64_t shamt = cpu_decode_shamt(inst);
     uint64_t rd = cpu_decode_rd(inst);
     cpu->registers[rd] = cpu->registers[rs1] << shamt;
-    printf("slli\n");
+    cpu_trace(cpu, "slli");
 }
 
 void cpu_exec_SLTI(CPU* cpu, uint32_t inst) {
@@ -121,7 +132,7 @@ void cpu_exec_SLTI(CPU* cpu, uint32_t inst) {
     uint64_t rs1 = cpu_decode_rs1(inst);
     uint64_t rd = cpu_decode_rd(inst);
     cpu->registers[rd] = (cpu->registers[rs1] < (int64_t)imm) ? 1 : 0;
-    printf("slti\n");
+    cpu_trace(cpu, "slti");
 }
 
 void cpu_exec_SLTIU(CPU* cpu, uint32_t inst) {
@@ -129,7 +140,7 @@ void cpu_exec_SLTIU(CPU* cpu, uint32_t inst) {
     uint64_t rs1 = cpu_decode_rs1(inst);
     uint64_t rd = cpu_decode_rd(inst);
     cpu->registers[rd] = (cpu->registers[rs1] < imm) ? 1 : 0;
-    printf("sltiu\n");
+    cpu_trace(cpu, "sltiu");
 }
 
 void cpu_exec_XORI(CPU* cpu, uint32_t inst) {
@@ -137,23 +148,23 @@ void cpu_exec_XORI(CPU* cpu, uint32_t inst) {
     uint64_t rs1 = cpu_decode_rs1(inst);
     uint64_t rd = cpu_decode_rd(inst);
     cpu->registers[rd] = cpu->registers[rs1] ^ imm;
-    printf("xori\n");
+    cpu_trace(cpu, "xori");
 }
 
 void cpu_exec_SRLI(CPU* cpu, uint32_t inst) {
-    uint64_t imm = cpu_decode_imm_I(inst);
     uint64_t rs1 = cpu_decode_rs1(inst);
+    uint64_t shamt = cpu_decode_shamt(inst);
     uint64_t rd = cpu_decode_rd(inst);
-    cpu->registers[rd] = cpu->registers[rs1] >> imm;
-    printf("srli\n");
+    cpu->registers[rd] = cpu->registers[rs1] >> shamt;
+    cpu_trace(cpu, "srli");
 }
 
 void cpu_exec_SRAI(CPU* cpu, uint32_t inst) {
-    uint64_t imm = cpu_decode_imm_I(inst);
     uint64_t rs1 = cpu_decode_rs1(inst);
+    uint64_t shamt = cpu_decode_shamt(inst);
     uint64_t rd = cpu_decode_rd(inst);
-    cpu->registers[rd] = (int32_t)cpu->registers[rs1] >> imm;
-    printf("srai\n");
+    cpu->registers[rd] = (int64_t)cpu->registers[rs1] >> shamt;
+    cpu_trace(cpu, "srai");
 }
 
 void cpu_exec_ORI(CPU* cpu, uint32_t inst) {
@@ -161,7 +172,7 @@ void cpu_exec_ORI(CPU* cpu, uint32_t inst) {
     uint64_t rs1 = cpu_decode_rs1(inst);
     uint64_t rd = cpu_decode_rd(inst);
     cpu->registers[rd] = cpu->registers[rs1] | imm;
-    printf("ori\n");
+    cpu_trace(cpu, "ori");
 }
 
 void cpu_exec_ANDI(CPU* cpu, uint32_t inst) {
@@ -169,44 +180,56 @@ void cpu_exec_ANDI(CPU* cpu, uint32_t inst) {
     uint64_t rs1 = cpu_decode_rs1(inst);
     uint64_t rd = cpu_decode_rd(inst);
     cpu->registers[rd] = cpu->registers[rs1] & imm;
-    printf("andi\n");
+    cpu_trace(cpu, "andi");
 }
 
 void cpu_exec_SB(CPU* cpu, uint32_t inst) {
     uint64_t imm = cpu_decode_imm_S(inst);
     uint64_t addr = cpu->registers[cpu_decode_rs1(inst)] + (int64_t)(imm);
     cpu_store(cpu, addr, 8, cpu->registers[cpu_decode_rs2(inst)]);
-    printf("sb\n");
+    cpu_trace(cpu, "sb");
 }
 
 void cpu_exec_SH(CPU* cpu, uint32_t inst) {
     uint64_t imm = cpu_decode_imm_S(inst);
     uint64_t addr = cpu->registers[cpu_decode_rs1(inst)] + (int64_t)(imm);
     cpu_store(cpu, addr, 16, cpu->registers[cpu_decode_rs2(inst)]);
-    printf("sh\n");
+    cpu_trace(cpu, "sh");
 }
 
 void cpu_exec_SW(CPU* cpu, uint32_t inst) {
     uint64_t imm = cpu_decode_imm_S(inst);
     uint64_t addr = cpu->registers[cpu_decode_rs1(inst)] + (int64_t)(imm);
     cpu_store(cpu, addr, 32, cpu->registers[cpu_decode_rs2(inst)]);
-    printf("sw\n");
+    cpu_trace(cpu, "sw");
 }
 
 void cpu_exec_SD(CPU* cpu, uint32_t inst) {
     uint64_t imm = cpu_decode_imm_S(inst);
     uint64_t addr = cpu->registers[cpu_decode_rs1(inst)] + (int64_t)(imm);
     cpu_store(cpu, addr, 64, cpu->registers[cpu_decode_rs2(inst)]);
-    printf("sd\n");
+    cpu_trace(cpu, "sd");
+}
+
+EXEC_RESULT cpu_exec_illegal(CPU *cpu, uint32_t inst) {
+    if (cpu->trace)
+        fprintf(
+            stderr,
+            "[-] ERROR-> opcode:0x%x, funct3:0x%x, funct7:0x%x\n",
+            inst & 0x7f, (inst >> 12) & 0x7, (inst >> 25) & 0x7f
+        );
+    return EXEC_ILLEGAL;
 }
 
-int32_t cpu_execute(CPU *cpu, uint32_t inst) {
+EXEC_RESULT cpu_execute(CPU *cpu, uint32_t inst) {
     int opcode = inst & 0x7f;           // inst[6:0]
     int funct3 = (inst >> 12) & 0x7;    // inst[14:12]
     int funct7 = (inst >> 25) & 0x7f;   // inst[31:25]
+    int funct6 = (inst >> 26) & 0x3f;   // inst[31:26]
 
     // emulate register (0x0) is hardwired with bits equal to 0 at each cycle
     cpu->registers[0] = 0;
+    cpu->mem_fault = 0;
 
     switch (opcode) {
         case R_TYPE:
@@ -217,7 +240,7 @@ int32_t cpu_execute(CPU *cpu, uint32_t inst) {
                             cpu_exec_ADD(cpu, inst); break;
                         case SUB:
                             cpu_exec_SUB(cpu, inst); break;
-                        default: ;
+                        default: return cpu_exec_illegal(cpu, inst);
                     } break;
                 case SLL:
                     cpu_exec_SLL(cpu, inst); break;
@@ -233,13 +256,13 @@ int32_t cpu_execute(CPU *cpu, uint32_t inst) {
                             cpu_exec_SRL(cpu, inst); break;
                         case SRA:
                             cpu_exec_SRA(cpu, inst); break;
-                        default: ;
+                        default: return cpu_exec_illegal(cpu, inst);
                     } break;
                 case OR:
                     cpu_exec_OR(cpu, inst); break;
                 case AND:
                     cpu_exec_AND(cpu, inst); break;
-                default: ;
+                default: return cpu_exec_illegal(cpu, inst);
             } break;
 
         case I_TYPE:
@@ -255,19 +278,19 @@ int32_t cpu_execute(CPU *cpu, uint32_t inst) {
                 case XORI:
                     cpu_exec_XORI(cpu, inst); break;
                 case SRI:
-                    switch (funct7) {
+                    switch (funct6) {
                         case SRLI:
                             cpu_exec_SRLI(cpu, inst); break;
                         case SRAI:
                             cpu_exec_SRAI(cpu, inst); break;
-                        default: ;
+                        default: return cpu_exec_illegal(cpu, inst);
                     } break;
 
                 case ORI:
                     cpu_exec_ORI(cpu, inst); break;
                 case ANDI:
                     cpu_exec_ANDI(cpu, inst); break;
-                default: ;
+                default: return cpu_exec_illegal(cpu, inst);
             } break;
 
         case S_TYPE:
@@ -280,19 +303,17 @@ int32_t cpu_execute(CPU *cpu, uint32_t inst) {
                     cpu_exec_SW(cpu, inst); break;
                 case SD:
                     cpu_exec_SD(cpu, inst); break;
-                default: ;
+                default: return cpu_exec_illegal(cpu, inst);
             } break;
 
         default:
-            fprintf(
-                stderr,
-                "[-] ERROR-> opcode:0x%x, funct3:0x%x, funct3:0x%x\n",
-                opcode, funct3, funct7
-            );
-            return 0;
+            return cpu_exec_illegal(cpu, inst);
     }
 
-    return 1;
+    if (cpu->mem_fault)
+        return EXEC_MEM_FAULT;
+
+    return EXEC_OK;
 }
 
 
@@ -347,8 +368,8 @@ uint64_t cpu_decode_imm_J(uint32_t inst) {
 }
 
 uint64_t cpu_decode_shamt(uint32_t inst) {
-    /* shamt[4:5] = imm[5:0] */
-    return cpu_decode_imm_I(inst) & 0x1f;
+    /* shamt[5:0] = imm[5:0] */
+    return cpu_decode_imm_I(inst) & 0x3f;
 }
 
 void cpu_dump_registers(CPU *cpu) {
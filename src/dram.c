@@ -2,6 +2,13 @@
 #include "risc.h"
 
 
+int dram_in_range(uint64_t addr, uint64_t len) {
+    /* written to avoid overflow when addr or len are near UINT64_MAX */
+    if (addr < DRAM_BASE || len > DRAM_SIZE)
+        return 0;
+    return addr - DRAM_BASE <= DRAM_SIZE - len;
+}
+
 void dram_store_8(DRAM *dram, uint64_t addr, uint64_t value) {
     /*
     AND with 0xff 8 (1's) to extract and store value
@@ -0,0 +1,131 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "risc.h"
+#include "machine.h"
+
+
+_Static_assert(MACHINE_DRAM_BASE == DRAM_BASE, "MACHINE_DRAM_BASE out of sync");
+_Static_assert(MACHINE_DRAM_SIZE == DRAM_SIZE, "MACHINE_DRAM_SIZE out of sync");
+
+struct MACHINE {
+    CPU cpu;
+    BUS bus;
+    DRAM dram;
+};
+
+static void machine_reset(MACHINE *machine) {
+    memset(machine->cpu.registers, 0, sizeof(machine->cpu.registers));
+    cpu_initialize(&machine->cpu);
+}
+
+MACHINE *machine_create(void) {
+    /* dram is too large for the stack—keep the whole machine on the heap */
+    MACHINE *machine = calloc(1, sizeof(MACHINE));
+    if (!machine)
+        return NULL;
+
+    machine->bus.dram = &machine->dram;
+    machine->cpu.bus = &machine->bus;
+    machine_reset(machine);
+
+    return machine;
+}
+
+void machine_destroy(MACHINE *machine) {
+    free(machine);
+}
+
+int machine_load(MACHINE *machine, const uint8_t *image, size_t len) {
+    if (len > DRAM_SIZE)
+        return 0;
+
+    memset(machine->dram.mem, 0, sizeof(machine->dram.mem));
+    memcpy(machine->dram.mem, image, len);
+    machine_reset(machine);
+
+    return 1;
+}
+
+STOP_REASON machine_run(MACHINE *machine, uint64_t max_steps, uint64_t *steps) {
+    CPU *cpu = &machine->cpu;
+    STOP_REASON reason = STOP_STEP_LIMIT;
+    uint64_t executed = 0;
+
+    while (executed < max_steps) {
+        uint64_t pc = cpu->program_counter;
+        if (!dram_in_range(pc, 4)) {
+            reason = STOP_FETCH_FAULT;
+            break;
+        }
+
+        uint32_t inst = cpu_fetch(cpu);
+
+        cpu->program_counter += 4;
+        EXEC_RESULT result = cpu_execute(cpu, inst);
+        if (result != EXEC_OK) {
+            cpu->program_counter = pc;
+            reason = (result == EXEC_MEM_FAULT)
+                ? STOP_MEMORY_FAULT
+                : STOP_ILLEGAL_INSTRUCTION;
+            break;
+        }
+
+        executed++;
+
+        if (cpu->program_counter == 0) {
+            reason = STOP_HALT;
+            break;
+        }
+    }
+
+    if (steps)
+        *steps = executed;
+
+    return reason;
+}
+
+uint64_t machine_get_register(MACHINE *machine, unsigned int reg) {
+    if (reg == 0 || reg >= 32)
+        return 0;
+    return machine->cpu.registers[reg];
+}
+
+void machine_set_register(MACHINE *machine, unsigned int reg, uint64_t value) {
+    if (reg == 0 || reg >= 32)
+        return;
+    machine->cpu.registers[reg] = value;
+}
+
+uint64_t machine_get_pc(MACHINE *machine) {
+    return machine->cpu.program_counter;
+}
+
+void machine_set_pc(MACHINE *machine, uint64_t pc) {
+    machine->cpu.program_counter = pc;
+}
+
+int machine_read_memory(MACHINE *machine, uint64_t addr, void *buf, size_t len) {
+    if (!dram_in_range(addr, len))
+        return 0;
+
+    memcpy(buf, &machine->dram.mem[addr - DRAM_BASE], len);
+    return 1;
+}
+
+int machine_write_memory(MACHINE *machine, uint64_t addr, const void *buf, size_t len) {
+    if (!dram_in_range(addr, len))
+        return 0;
+
+    memcpy(&machine->dram.mem[addr - DRAM_BASE], buf, len);
+    return 1;
+}
+
+void machine_set_trace(MACHINE *machine, int enabled) {
+    machine->cpu.trace = enabled;
+}
+
+void machine_dump_registers(MACHINE *machine) {
+    cpu_dump_registers(&machine->cpu);
+}
@@ -0,0 +1,73 @@
+#ifndef MACHINE_H
+#define MACHINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/*
+------ MACHINE -------
+Embeddable interface to the emulator. A machine owns its own CPU, BUS and
+DRAM so any number of machines can live side-by-side in one process. The
+structure is opaque—use the accessors below to inspect or modify state.
+*/
+
+typedef struct MACHINE MACHINE;
+
+/* Guest address range backed by dram—mirrors DRAM_BASE/DRAM_SIZE */
+#define MACHINE_DRAM_BASE 0x80000000
+#define MACHINE_DRAM_SIZE (1024 * 1024 * 1)
+
+/*
+Reasons machine_run hands control back to the caller. STOP_HALT cannot
+occur yet. The decoder has no jump or branch instructions, and sequential
+execution stops with STOP_FETCH_FAULT at the end of dram before the
+program-counter could wrap to 0.
+*/
+typedef enum{
+    STOP_STEP_LIMIT,            // requested number of instructions executed
+    STOP_HALT,                  // program-counter jumped to 0 (see above)
+    STOP_ILLEGAL_INSTRUCTION,   // decoder did not recognise the instruction
+    STOP_FETCH_FAULT,           // program-counter left the dram address space
+    STOP_MEMORY_FAULT,          // a load or store accessed an unmapped address
+}STOP_REASON;
+
+/* Allocates and initializes a machine—returns NULL if allocation fails */
+MACHINE *machine_create(void);
+
+void machine_destroy(MACHINE *machine);
+
+/*
+Clears dram, copies image to the start of dram (MACHINE_DRAM_BASE) and resets the
+CPU. Returns 0 if the image does not fit in dram, 1 otherwise.
+*/
+int machine_load(MACHINE *machine, const uint8_t *image, size_t len);
+
+/*
+Executes up to max_steps instructions, stopping early on any other event.
+The number of instructions retired is written to steps if it is non-NULL.
+On STOP_ILLEGAL_INSTRUCTION and STOP_MEMORY_FAULT the program-counter points
+at the offending instruction.
+*/
+STOP_REASON machine_run(MACHINE *machine, uint64_t max_steps, uint64_t *steps);
+
+/* Register access—reads of x0 return 0 and writes to x0 are ignored */
+uint64_t machine_get_register(MACHINE *machine, unsigned int reg);
+void machine_set_register(MACHINE *machine, unsigned int reg, uint64_t value);
+
+uint64_t machine_get_pc(MACHINE *machine);
+void machine_set_pc(MACHINE *machine, uint64_t pc);
+
+/*
+Copies len bytes between dram and buf, addr is a guest address. Returns 0
+if any part of the range falls outside dram, 1 otherwise.
+*/
+int machine_read_memory(MACHINE *machine, uint64_t addr, void *buf, size_t len);
+int machine_write_memory(MACHINE *machine, uint64_t addr, const void *buf, size_t len);
+
+/* Prints each executed instruction and decode errors—off by default */
+void machine_set_trace(MACHINE *machine, int enabled);
+
+void machine_dump_registers(MACHINE *machine);
+
+#endif
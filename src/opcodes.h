@@ -18,9 +18,9 @@
     #define SLTI    0x2
     #define SLTIU   0x3
     #define XORI    0x4
-    #define SRI     0x5
+    #define SRI     0x5         // RV64I: selected by funct6, inst[25] is shamt[5]
         #define SRLI    0x00
-        #define SRAI    0x20
+        #define SRAI    0x10
     #define ORI     0x6
     #define ANDI    0x7
 
@@ -21,6 +21,9 @@ as 8-bit chunks in little-endian order
 uint64_t dram_load(DRAM* dram, uint64_t addr, uint64_t size);
 void dram_store(DRAM* dram, uint64_t addr, uint64_t size, uint64_t value);
 
+/* Returns 1 if all len bytes starting at addr fall inside dram, 0 otherwise */
+int dram_in_range(uint64_t addr, uint64_t len);
+
 
 /*
 ------ Memory BUS -------
@@ -31,8 +34,12 @@ typedef struct{
     DRAM *dram;
 }BUS;
 
-uint64_t bus_load(BUS* bus, uint64_t addr, uint64_t size);
-void bus_store(BUS* bus, uint64_t addr, uint64_t size, uint64_t value);
+/*
+Loads and stores return 0 if the access falls outside every device on the
+bus (an access fault), 1 otherwise. Loaded values are written to value.
+*/
+int bus_load(BUS* bus, uint64_t addr, uint64_t size, uint64_t *value);
+int bus_store(BUS* bus, uint64_t addr, uint64_t size, uint64_t value);
 
 
 /* ------ CPU ------- */
@@ -41,8 +48,17 @@ typedef struct{
     uint64_t registers[32];
     uint64_t program_counter;
     BUS *bus;
+    int mem_fault;  // set when a load or store faults during cpu_execute
+    int trace;      // print each executed instruction and decode errors
 }CPU;
 
+/* Results returned by cpu_execute—compare against EXEC_OK, not truthiness */
+typedef enum{
+    EXEC_OK = 0,
+    EXEC_ILLEGAL,       // instruction could not be decoded
+    EXEC_MEM_FAULT,     // a load or store accessed an unmapped address
+}EXEC_RESULT;
+
 /* Initializes CPU registers and aligns program-counter with start of DRAM */
 void cpu_initialize(CPU *cpu);
 
@@ -50,7 +66,7 @@ void cpu_initialize(CPU *cpu);
 uint32_t cpu_fetch(CPU *cpu);
 
 /* A basic ALU and decoder—decodes a fetched instruction and executes it */
-int cpu_execute(CPU *cpu, uint32_t inst);
+EXEC_RESULT cpu_execute(CPU *cpu, uint32_t inst);
 
 void cpu_dump_registers(CPU *cpu);
 
@@ -95,5 +111,5 @@ uint64_t cpu_decode_imm_U(uint32_t inst);
 /* imm[20|10:1|11|19:12] of inst[31|30:21|20|19:12] */
 uint64_t cpu_decode_imm_J(uint32_t inst);
 
-/* Returns shamt register—5-bit address of destination register [5:0] */
+/* Returns shamt—6-bit RV64I shift amount imm[5:0] */
 uint64_t cpu_decode_shamt(uint32_t inst);
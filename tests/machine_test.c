@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/machine.h"
+
+
+static int failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+        failures++; \
+    } \
+} while (0)
+
+/* tests/add_addi.s */
+static const uint32_t ADD_ADDI[] = {
+    0x00500e93,     // addi x29, x0, 5
+    0x02500f13,     // addi x30, x0, 37
+    0x01df0fb3,     // add x31, x30, x29
+};
+
+static MACHINE *load_program(const uint32_t *words, size_t count) {
+    MACHINE *machine = machine_create();
+    if (!machine) {
+        // every test needs a machine—nothing useful can run without one
+        fprintf(stderr, "%s:%d: machine_create failed\n", __FILE__, __LINE__);
+        exit(1);
+    }
+
+    CHECK(machine_load(machine, (const uint8_t *)words, count * sizeof(uint32_t)));
+    return machine;
+}
+
+static void test_add_addi(void) {
+    MACHINE *machine = load_program(ADD_ADDI, 3);
+    uint64_t steps;
+
+    // a slice that hits the step limit can be resumed by the next call
+    CHECK(machine_run(machine, 1, &steps) == STOP_STEP_LIMIT);
+    CHECK(steps == 1);
+    CHECK(machine_get_register(machine, 29) == 5);
+    CHECK(machine_get_pc(machine) == MACHINE_DRAM_BASE + 4);
+
+    CHECK(machine_run(machine, 1, &steps) == STOP_STEP_LIMIT);
+    CHECK(steps == 1);
+    CHECK(machine_get_register(machine, 30) == 37);
+
+    // the zeroed word after the program is not a valid instruction
+    CHECK(machine_run(machine, 100, &steps) == STOP_ILLEGAL_INSTRUCTION);
+    CHECK(steps == 1);
+    CHECK(machine_get_register(machine, 31) == 42);
+    CHECK(machine_get_pc(machine) == MACHINE_DRAM_BASE + 12);
+
+    machine_destroy(machine);
+}
+
+static void test_illegal_instruction(void) {
+    const uint32_t program[] = {
+        0x00500e93,     // addi x29, x0, 5
+        0x03df0fb3,     // mul x31, x30, x29 (unknown funct7 for R_TYPE)
+    };
+    MACHINE *machine = load_program(program, 2);
+    uint64_t steps;
+
+    CHECK(machine_run(machine, 100, &steps) == STOP_ILLEGAL_INSTRUCTION);
+    CHECK(steps == 1);
+    CHECK(machine_get_pc(machine) == MACHINE_DRAM_BASE + 4);
+    CHECK(machine_get_register(machine, 31) == 0);
+
+    machine_destroy(machine);
+}
+
+static void test_shift_immediate(void) {
+    const uint32_t program[] = {
+        0x0200d093,     // srli x1, x1, 32
+        0x4281d113,     // srai x2, x3, 40
+    };
+    MACHINE *machine = load_program(program, 2);
+    uint64_t steps;
+
+    // RV64I shift amounts >= 32 set inst[25], which is part of shamt
+    machine_set_register(machine, 1, 0xf000000000000000);
+    machine_set_register(machine, 3, 0x8000000000000000);
+    CHECK(machine_run(machine, 2, &steps) == STOP_STEP_LIMIT);
+    CHECK(steps == 2);
+    CHECK(machine_get_register(machine, 1) == 0xf0000000);
+    CHECK(machine_get_register(machine, 2) == 0xffffffffff800000);
+
+    machine_destroy(machine);
+}
+
+static void test_fetch_fault(void) {
+    MACHINE *machine = load_program(ADD_ADDI, 3);
+    uint32_t inst = ADD_ADDI[0];
+    uint64_t steps;
+
+    // last word of dram executes, the next fetch is outside dram
+    CHECK(machine_write_memory(machine, MACHINE_DRAM_BASE + MACHINE_DRAM_SIZE - 4, &inst, 4));
+    machine_set_pc(machine, MACHINE_DRAM_BASE + MACHINE_DRAM_SIZE - 4);
+    CHECK(machine_run(machine, 100, &steps) == STOP_FETCH_FAULT);
+    CHECK(steps == 1);
+    CHECK(machine_get_register(machine, 29) == 5);
+    CHECK(machine_get_pc(machine) == MACHINE_DRAM_BASE + MACHINE_DRAM_SIZE);
+
+    // a fetch straddling the end of dram also faults
+    machine_set_pc(machine, MACHINE_DRAM_BASE + MACHINE_DRAM_SIZE - 2);
+    CHECK(machine_run(machine, 100, &steps) == STOP_FETCH_FAULT);
+    CHECK(steps == 0);
+
+    machine_destroy(machine);
+}
+
+static void test_memory_fault(void) {
+    const uint32_t store_sp[] = { 0x00113023 };    // sd x1, 0(sp)
+    const uint32_t store_zero[] = { 0x00000023 };  // sb x0, 0(x0)
+    uint64_t steps, value;
+
+    // sp starts at the end of dram so storing through it faults
+    MACHINE *machine = load_program(store_sp, 1);
+    CHECK(machine_run(machine, 100, &steps) == STOP_MEMORY_FAULT);
+    CHECK(steps == 0);
+    CHECK(machine_get_pc(machine) == MACHINE_DRAM_BASE);
+
+    // the same store succeeds once sp points inside dram
+    machine_set_register(machine, 1, 0x1122334455667788);
+    machine_set_register(machine, 2, MACHINE_DRAM_BASE + 0x100);
+    CHECK(machine_run(machine, 1, &steps) == STOP_STEP_LIMIT);
+    CHECK(steps == 1);
+    CHECK(machine_read_memory(machine, MACHINE_DRAM_BASE + 0x100, &value, 8));
+    CHECK(value == 0x1122334455667788);
+    machine_destroy(machine);
+
+    machine = load_program(store_zero, 1);
+    CHECK(machine_run(machine, 100, &steps) == STOP_MEMORY_FAULT);
+    CHECK(steps == 0);
+    CHECK(machine_get_pc(machine) == MACHINE_DRAM_BASE);
+    machine_destroy(machine);
+}
+
+static void test_machine_isolation(void) {
+    const uint32_t program[] = { 0x00700e93 };  // addi x29, x0, 7
+    MACHINE *a = load_program(ADD_ADDI, 3);
+    MACHINE *b = load_program(program, 1);
+    uint32_t word = 0xdeadbeef, read;
+
+    CHECK(machine_run(a, 3, NULL) == STOP_STEP_LIMIT);
+    CHECK(machine_run(b, 1, NULL) == STOP_STEP_LIMIT);
+    CHECK(machine_get_register(a, 29) == 5);
+    CHECK(machine_get_register(b, 29) == 7);
+    CHECK(machine_get_register(b, 31) == 0);
+
+    CHECK(machine_write_memory(b, MACHINE_DRAM_BASE, &word, 4));
+    CHECK(machine_read_memory(a, MACHINE_DRAM_BASE, &read, 4));
+    CHECK(read == ADD_ADDI[0]);
+
+    machine_destroy(a);
+    machine_destroy(b);
+}
+
+int main(void) {
+    test_add_addi();
+    test_illegal_instruction();
+    test_shift_immediate();
+    test_fetch_fault();
+    test_memory_fault();
+    test_machine_isolation();
+
+    if (failures) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+
+    printf("all machine tests passed\n");
+    return 0;
+}